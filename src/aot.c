@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+
+#include "aot.h"
+
+
+static void write_int(FILE* f, long int v) {
+    if(v == LONG_MIN) { fprintf(f, "LONG_MIN"); }
+    else { fprintf(f, "%ldL", v); }
+}
+
+// NaN is written as its exact bits, the sign (and payload) of it are visible when it is printed or written to a snapshot
+static void write_float(FILE* f, double v) {
+    if(isnan(v)) {
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(double));
+        fprintf(f, "float_bits(0x%016llxULL)", (unsigned long long) bits);
+    }
+    else if(isinf(v)) { fprintf(f, v < 0? "-INFINITY" : "INFINITY"); }
+    else { fprintf(f, "%a", v); }
+}
+
+// the program strings are written out as they are, all expressions and string literals are a part of them
+static void write_strings(FILE* f, Program* p) {
+    fprintf(f, "static char strings[] = {");
+    for(size_t c = 0; c < p->strings_size; c += 1) {
+        if(c % 16 == 0) { fprintf(f, "\n   "); }
+        fprintf(f, " 0x%02x,", (unsigned char) p->strings[c]);
+    }
+    fprintf(f, "\n};\n\n");
+}
+
+// the runtime function every other instruction is translated to, and the arguments it takes
+typedef enum Arguments {
+    PrimaryOnly,   // (primary)
+    PrimaryRandom, // (primary, rng)
+    BothStacks,    // (primary, secondary)
+    Located,       // (primary, secondary, expression, position)
+    LocatedRandom  // (primary, secondary, rng, expression, position)
+} Arguments;
+
+static struct { char* function; Arguments arguments; } operations[] = {
+    [Copy] = { "instruction_copy", Located },
+    [Remove] = { "instruction_remove", Located },
+    [Swap] = { "instruction_swap", Located },
+    [ToSecondary] = { "instruction_to_secondary", Located },
+    [ToPrimary] = { "instruction_to_primary", Located },
+    [Input] = { "instruction_input", PrimaryOnly },
+    [Print] = { "instruction_print", Located },
+    [Add] = { "instruction_add", Located },
+    [Subtract] = { "instruction_subtract", Located },
+    [Multiply] = { "instruction_multiply", Located },
+    [Divide] = { "instruction_divide", Located },
+    [Modulo] = { "instruction_modulo", Located },
+    [Less] = { "instruction_less", Located },
+    [Greater] = { "instruction_greater", Located },
+    [Equal] = { "instruction_equal", Located },
+    [And] = { "instruction_and", Located },
+    [Or] = { "instruction_or", Located },
+    [Branch] = { "instruction_branch", LocatedRandom },
+    [Loop] = { "instruction_loop", LocatedRandom },
+    [ArrayCreate] = { "instruction_array_create", PrimaryOnly },
+    [ArrayPush] = { "instruction_array_push", Located },
+    [ArrayGet] = { "instruction_array_get", Located },
+    [ArraySet] = { "instruction_array_set", Located },
+    [ArrayRemove] = { "instruction_array_remove", Located },
+    [ArrayLength] = { "instruction_array_length", Located },
+    [Reset] = { "instruction_reset", BothStacks },
+    [PrintRaw] = { "instruction_print_raw", Located },
+    [Debug] = { "instruction_debug", BothStacks },
+    [PrimarySize] = { "instruction_primary_size", PrimaryOnly },
+    [SecondarySize] = { "instruction_secondary_size", BothStacks },
+    [SnapshotWrite] = { "instruction_snapshot_write", Located },
+    [SnapshotRead] = { "instruction_snapshot_read", Located },
+    [StringMerge] = { "instruction_string_merge", Located },
+    [Substring] = { "instruction_substring", Located },
+    [StringLength] = { "instruction_string_length", Located },
+    [RandomFloat] = { "instruction_random_float", PrimaryRandom },
+    [RandomSeed] = { "instruction_random_seed", LocatedRandom },
+    [RandomFloats] = { "instruction_random_floats", LocatedRandom },
+    [RandomInts] = { "instruction_random_ints", LocatedRandom },
+    [ToFloat] = { "instruction_to_float", Located },
+    [RoundUp] = { "instruction_round_up", Located },
+    [RoundDown] = { "instruction_round_down", Located },
+    [RoundNearest] = { "instruction_round_nearest", Located },
+    [Sine] = { "instruction_sine", Located },
+    [Cosine] = { "instruction_cosine", Located },
+    [Tangent] = { "instruction_tangent", Located },
+    [Absolute] = { "instruction_absolute", Located },
+    [SquareRoot] = { "instruction_square_root", Located },
+    [Power] = { "instruction_power", Located },
+    [Invalid] = { "instruction_invalid", Located },
+    [UnclosedString] = { "instruction_unclosed_string", Located },
+};
+
+// each instruction is translated to the operation itself, jumps become gotos.
+// the expression and position of an instruction are only passed on so that errors get reported exactly as by the interpreter.
+static void write_code(FILE* f, Program* p) {
+    char* targets = calloc(p->size + 1, 1);
+    for(size_t i = 0; i < p->size; i += 1) {
+        Instruction* ins = &p->instructions[i];
+        if(ins->type == Jump || ins->type == JumpUnless) { targets[ins->value.target] = 1; }
+    }
+    fprintf(f, "static void run(Stack* primary, Stack* secondary, Random* rng) {\n");
+    // not every program uses the strings, both stacks and the random number generator
+    fprintf(f, "    (void) strings;\n    (void) primary;\n    (void) secondary;\n    (void) rng;\n");
+    for(size_t i = 0; i < p->size; i += 1) {
+        Instruction* ins = &p->instructions[i];
+        if(targets[i]) { fprintf(f, "    i%zu:\n", i); }
+        fprintf(f, "    ");
+        switch(ins->type) {
+            case PushInt: fprintf(f, "stack_push(primary, value_int("); write_int(f, ins->value.i); fprintf(f, "));\n"); break;
+            case PushFloat: fprintf(f, "stack_push(primary, value_float("); write_float(f, ins->value.f); fprintf(f, "));\n"); break;
+            case PushString: fprintf(f, "stack_push(primary, value_string(strings + %zu));\n", ins->value.s); break;
+            case Jump: fprintf(f, "goto i%zu;\n", ins->value.target); break;
+            case JumpUnless: {
+                fprintf(f, "if(!instruction_condition(primary, secondary, strings + %zu, strings + %zu)) { goto i%zu; }\n", ins->expression, ins->position, ins->value.target);
+            } break;
+            default: {
+                fprintf(f, "%s(", operations[ins->type].function);
+                switch(operations[ins->type].arguments) {
+                    case PrimaryOnly: fprintf(f, "primary"); break;
+                    case PrimaryRandom: fprintf(f, "primary, rng"); break;
+                    case BothStacks: fprintf(f, "primary, secondary"); break;
+                    case Located: fprintf(f, "primary, secondary, strings + %zu, strings + %zu", ins->expression, ins->position); break;
+                    case LocatedRandom: fprintf(f, "primary, secondary, rng, strings + %zu, strings + %zu", ins->expression, ins->position); break;
+                }
+                fprintf(f, ");\n");
+            }
+        }
+    }
+    if(targets[p->size]) { fprintf(f, "    i%zu:\n", p->size); }
+    fprintf(f, "    return;\n");
+    fprintf(f, "}\n\n");
+    free(targets);
+}
+
+// the program accepts the same options as the interpreter (except for the ones about compiling it)
+static void write_main(FILE* f) {
+    fprintf(f,
+        "int main(int argc, char** argv) {\n"
+        "    Options options = options_new();\n"
+        "    for(int a = 1; a < argc; a += 1) {\n"
+        "        int parsed = options_parse(&options, argc, argv, &a);\n"
+        "        if(parsed < 0) { return 1; }\n"
+        "        if(parsed == 0) {\n"
+        "            printf(\"Usage: %%s \" OPTIONS_USAGE \"\\n\", argv[0]);\n"
+        "            return 1;\n"
+        "        }\n"
+        "    }\n"
+        "\n"
+        "    Random r;\n"
+        "    Stack p;\n"
+        "    Stack s;\n"
+        "    if(options_apply(&options, &p, &s, &r)) { return 1; }\n"
+        "    run(&p, &s, &r);\n"
+        "    stack_free(&p);\n"
+        "    stack_free(&s);\n"
+        "\n"
+        "    return 0;\n"
+        "}\n"
+    );
+}
+
+// writes a C file that executes the program when built together with the runtime (all sources except main.c), returns 0 on success
+int aot_write(char* path, Program* p) {
+    FILE* f = fopen(path, "w");
+    if(f == NULL) { return 1; }
+    fprintf(f, "// generated by silicon-runes\n\n");
+    fprintf(f, "#include <stdio.h>\n#include <string.h>\n#include <stdint.h>\n#include <limits.h>\n#include <math.h>\n\n");
+    fprintf(f, "#include \"runtime.h\"\n#include \"instructions.h\"\n#include \"options.h\"\n\n\n");
+    fprintf(f, "static inline double float_bits(uint64_t bits) {\n    double f;\n    memcpy(&f, &bits, sizeof(double));\n    return f;\n}\n\n");
+    write_strings(f, p);
+    write_code(f, p);
+    write_main(f);
+    int failed = ferror(f);
+    failed |= fclose(f) != 0;
+    return failed;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "runtime.h"
+
+
+int aot_write(char* path, Program* p);
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "cache.h"
+#include "compiler.h"
+#include "file.h"
+#include "intern.h"
+
+
+// bytecode cache file layout:
+//   header
+//   instructions (exactly as they are in memory)
+//   program strings (starting with the source the program was compiled from)
+// the file is mapped into memory and executed from there, so it is only valid for the same build of the interpreter (see 'build_fingerprint').
+
+#define CACHE_MAGIC "SRBC"
+#define CACHE_VERSION 2
+
+typedef struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t fingerprint;
+    uint64_t hash;
+    uint64_t source_size;
+    uint64_t size;
+    uint64_t strings_size;
+} CacheHeader;
+
+// hash of the compiler version, the layout of instructions and the names of all instruction types in order.
+// adding, removing or reordering instruction types invalidates all cache files by itself, changes to what gets compiled
+// to which instructions only do so through COMPILER_VERSION.
+static uint64_t build_fingerprint() {
+    size_t layout[] = {
+        COMPILER_VERSION,
+        sizeof(Instruction), offsetof(Instruction, value), offsetof(Instruction, expression), offsetof(Instruction, position),
+        instruction_count
+    };
+    size_t size = sizeof(layout);
+    for(size_t t = 0; t < instruction_count; t += 1) { size += strlen(instruction_names[t]) + 1; }
+    char* data = malloc(size);
+    memcpy(data, layout, sizeof(layout));
+    size_t offset = sizeof(layout);
+    for(size_t t = 0; t < instruction_count; t += 1) {
+        size_t length = strlen(instruction_names[t]) + 1;
+        memcpy(data + offset, instruction_names[t], length);
+        offset += length;
+    }
+    uint64_t fingerprint = hash_bytes(data, size);
+    free(data);
+    return fingerprint;
+}
+
+// the cache file is put next to the file (or into the directory, named after the hash of the source)
+char* cache_path(char* file, char* directory, char* source) {
+    char* path;
+    if(directory != NULL) {
+        unsigned long long hash = hash_bytes(source, strlen(source));
+        path = malloc(strlen(directory) + 1 + 16 + 4 + 1);
+        sprintf(path, "%s/%016llx.srb", directory, hash);
+    } else {
+        path = malloc(strlen(file) + 4 + 1);
+        sprintf(path, "%s.srb", file);
+    }
+    return path;
+}
+
+// maps the cache file into memory, returns 0 if it contains the program compiled from the given source
+int cache_open(char* path, char* source, Cache* c) {
+    size_t size = 0;
+    char* data = file_map(path, &size);
+    if(data == NULL) { return 1; }
+    CacheHeader* h = (CacheHeader*) data;
+    size_t source_size = strlen(source);
+    if(size < sizeof(CacheHeader)
+        || memcmp(h->magic, CACHE_MAGIC, 4) != 0
+        || h->version != CACHE_VERSION
+        || h->fingerprint != build_fingerprint()
+        || h->size > (size - sizeof(CacheHeader)) / sizeof(Instruction)
+        || h->strings_size != size - sizeof(CacheHeader) - h->size * sizeof(Instruction)
+        || h->hash != hash_bytes(source, source_size)
+        || h->source_size != source_size
+        || h->strings_size <= source_size
+        || data[size - 1] != '\0') {
+        file_unmap(data, size);
+        return 1;
+    }
+    Program p = {
+        .instructions = (Instruction*) (data + sizeof(CacheHeader)),
+        .size = h->size,
+        .malloc_size = h->size,
+        .strings = data + sizeof(CacheHeader) + h->size * sizeof(Instruction),
+        .strings_size = h->strings_size,
+        .strings_malloc_size = h->strings_size
+    };
+    int valid = memcmp(p.strings, source, source_size + 1) == 0;
+    // make sure that executing the instructions never reads outside of the file
+    for(size_t i = 0; valid && i < p.size; i += 1) {
+        Instruction* ins = &p.instructions[i];
+        valid = (size_t) ins->type < instruction_count && ins->expression < p.strings_size && ins->position < p.strings_size;
+        if(ins->type == PushString) { valid = valid && ins->value.s < p.strings_size; }
+        if(ins->type == Jump || ins->type == JumpUnless) { valid = valid && ins->value.target <= p.size; }
+    }
+    if(!valid) {
+        file_unmap(data, size);
+        return 1;
+    }
+    c->data = data;
+    c->size = size;
+    c->program = p;
+    return 0;
+}
+
+void cache_close(Cache* c) {
+    file_unmap(c->data, c->size);
+}
+
+// writes the program compiled from the given source to the cache file, returns 0 on success
+int cache_write(char* path, char* source, Program* p) {
+    CacheHeader h = {
+        .magic = CACHE_MAGIC,
+        .version = CACHE_VERSION,
+        .fingerprint = build_fingerprint(),
+        .hash = hash_bytes(source, strlen(source)),
+        .source_size = strlen(source),
+        .size = p->size,
+        .strings_size = p->strings_size
+    };
+    // written to a temporary file of its own first, so that a partially written cache file is never read
+    // (even if the same file is executed multiple times at once)
+    char* temporary;
+    FILE* f = file_create(path, &temporary);
+    if(f == NULL) { return 1; }
+    int failed = fwrite(&h, 1, sizeof(CacheHeader), f) != sizeof(CacheHeader)
+        || fwrite(p->instructions, sizeof(Instruction), p->size, f) != p->size
+        || fwrite(p->strings, 1, p->strings_size, f) != p->strings_size;
+    return file_commit(f, temporary, path, failed);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "runtime.h"
+
+
+typedef struct Cache {
+    char* data;
+    size_t size;
+    Program program;
+} Cache;
+
+char* cache_path(char* file, char* directory, char* source);
+int cache_open(char* path, char* source, Cache* c);
+void cache_close(Cache* c);
+int cache_write(char* path, char* source, Program* p);
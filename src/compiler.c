@@ -0,0 +1,242 @@
+#include <string.h>
+#include <stdlib.h>
+
+#include "compiler.h"
+#include "optimizer.h"
+#include "intern.h"
+
+
+#define IS_DIGIT(c) ('0' <= (c) && (c) <= '9')
+
+typedef struct Compiler {
+    Program* program;
+    // all string literals so far
+    InternTable interned;
+} Compiler;
+
+// copies the string at the given offset inside of the program strings, unless an identical string literal has been copied before
+static size_t intern_string(Compiler* c, size_t start, size_t length) {
+    Program* p = c->program;
+    size_t offset = intern_find(&c->interned, p->strings, p->strings_size, p->strings + start, length);
+    if(offset != INTERN_MISSING) { return offset; }
+    offset = program_add_string(p, p->strings + start, length);
+    intern_add(&c->interned, p->strings, offset);
+    return offset;
+}
+
+// compiles the expression at the given offset inside of the program strings and appends it to the program.
+// instructions before 'barrier' may not be optimized together with the ones of the expression, the returned barrier applies after it.
+static size_t compile_expression(Compiler* c, size_t expression, size_t barrier) {
+    Program* p = c->program;
+    size_t i = expression;
+    while(p->strings[i] != '\0') {
+        Instruction ins = { .expression = expression, .position = i };
+        switch(p->strings[i]) {
+            // no op
+            case ' ': case '\n': {
+                i += 1;
+            } continue;
+
+            // number
+            case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': {
+                size_t start = i;
+                while(IS_DIGIT(p->strings[i])) {
+                    i += 1;
+                }
+                int is_float = 0;
+                if(i != start && p->strings[i] == '.' && IS_DIGIT(p->strings[i + 1])) {
+                    i += 1;
+                    is_float = 1;
+                }
+                while(IS_DIGIT(p->strings[i])) {
+                    i += 1;
+                }
+                size_t number_length = i - start;
+                char number[number_length + 1];
+                memcpy(number, p->strings + start, number_length);
+                number[number_length] = '\0';
+                if(is_float) {
+                    ins.type = PushFloat;
+                    ins.value.f = strtod(number, NULL);
+                } else {
+                    ins.type = PushInt;
+                    ins.value.i = strtol(number, NULL, 10);
+                }
+                i -= 1; // will be increased again after the switch
+            } break;
+            // string
+            case '(': {
+                i += 1;
+                size_t start = i;
+                int scope = 1;
+                while(scope != 1 || p->strings[i] != ')') {
+                    if(p->strings[i] == '\0') {
+                        ins.type = UnclosedString;
+                        ins.position = i;
+                        program_push(p, ins);
+                        return barrier;
+                    }
+                    if(p->strings[i] == '(') { scope += 1; }
+                    if(p->strings[i] == ')') { scope -= 1; }
+                    i += 1;
+                }
+                ins.type = PushString;
+                ins.value.s = intern_string(c, start, i - start);
+            } break;
+
+            case ':': ins.type = Copy; break;
+            case '^': ins.type = Remove; break;
+            case '$': ins.type = Swap; break;
+            case '#': ins.type = ToSecondary; break;
+            case '\'': ins.type = ToPrimary; break;
+            case ',': ins.type = Input; break;
+            case '!': ins.type = Print; break;
+            case '+': ins.type = Add; break;
+            case '-': ins.type = Subtract; break;
+            case '*': ins.type = Multiply; break;
+            case '/': ins.type = Divide; break;
+            case '%': ins.type = Modulo; break;
+            case '<': ins.type = Less; break;
+            case '>': ins.type = Greater; break;
+            case '=': ins.type = Equal; break;
+            case '&': ins.type = And; break;
+            case '|': ins.type = Or; break;
+
+            // a branch on a string literal gets compiled in place (and removed or inlined if the condition is constant)
+            case '?': {
+                size_t last = p->size - 1;
+                if(p->size < barrier + 1 || p->instructions[last].type != PushString) {
+                    ins.type = Branch;
+                    break;
+                }
+                size_t body = p->instructions[last].value.s;
+                p->size -= 1;
+                int truthy;
+                if(p->size >= barrier + 1 && optimize_constant(p, p->size - 1, &truthy)) {
+                    p->size -= 1;
+                    if(truthy) {
+                        barrier = compile_expression(c, body, barrier);
+                    }
+                } else {
+                    size_t jump = p->size;
+                    ins.type = JumpUnless;
+                    program_push(p, ins);
+                    compile_expression(c, body, p->size);
+                    p->instructions[jump].value.target = p->size;
+                    barrier = p->size;
+                }
+                i += 1;
+            } continue;
+            // a loop on two string literals gets compiled in place, making sure literals inside of it only get parsed once
+            case '@': {
+                size_t last = p->size - 1;
+                if(p->size < barrier + 2 || p->instructions[last - 1].type != PushString || p->instructions[last].type != PushString) {
+                    ins.type = Loop;
+                    break;
+                }
+                size_t condition = p->instructions[last - 1].value.s;
+                size_t body = p->instructions[last].value.s;
+                p->size -= 2;
+                size_t start = p->size;
+                compile_expression(c, condition, start);
+                size_t jump = p->size;
+                ins.type = JumpUnless;
+                program_push(p, ins);
+                compile_expression(c, body, p->size);
+                ins.type = Jump;
+                ins.value.target = start;
+                program_push(p, ins);
+                p->instructions[jump].value.target = p->size;
+                barrier = p->size;
+                i += 1;
+            } continue;
+
+            // array-related instruction
+            case 'A': {
+                i += 1;
+                ins.position = i; // errors get reported at the second character
+                switch(p->strings[i]) {
+                    case 'c': ins.type = ArrayCreate; break;
+                    case 'p': ins.type = ArrayPush; break;
+                    case 'g': ins.type = ArrayGet; break;
+                    case 's': ins.type = ArraySet; break;
+                    case 'r': ins.type = ArrayRemove; break;
+                    case 'l': ins.type = ArrayLength; break;
+                    default: ins.type = Invalid;
+                }
+            } break;
+            // interpreter-related instruction
+            case 'I': {
+                i += 1;
+                ins.position = i; // errors get reported at the second character
+                switch(p->strings[i]) {
+                    case 'r': ins.type = Reset; break;
+                    case 'p': ins.type = PrintRaw; break;
+                    case 'd': ins.type = Debug; break;
+                    case 'P': ins.type = PrimarySize; break;
+                    case 'S': ins.type = SecondarySize; break;
+                    case 'w': ins.type = SnapshotWrite; break;
+                    case 'l': ins.type = SnapshotRead; break;
+                    default: ins.type = Invalid;
+                }
+            } break;
+            // string-related instruction
+            case 'S': {
+                i += 1;
+                ins.position = i; // errors get reported at the second character
+                switch(p->strings[i]) {
+                    case 'm': ins.type = StringMerge; break;
+                    case 's': ins.type = Substring; break;
+                    case 'l': ins.type = StringLength; break;
+                    default: ins.type = Invalid;
+                }
+            } break;
+            // math-related instruction
+            case 'M': {
+                i += 1;
+                ins.position = i; // errors get reported at the second character
+                switch(p->strings[i]) {
+                    case 'P': ins.type = PushFloat; ins.value.f = 3.14159265358979323846; break;
+                    case 'T': ins.type = PushFloat; ins.value.f = 6.28318530717958647692; break;
+                    case 'E': ins.type = PushFloat; ins.value.f = 2.7182818284590452354; break;
+                    case 'R': ins.type = RandomFloat; break;
+                    case 'S': ins.type = RandomSeed; break;
+                    case 'A': ins.type = RandomFloats; break;
+                    case 'I': ins.type = RandomInts; break;
+                    case 'f': ins.type = ToFloat; break;
+                    case 'u': ins.type = RoundUp; break;
+                    case 'd': ins.type = RoundDown; break;
+                    case 'n': ins.type = RoundNearest; break;
+                    case 's': ins.type = Sine; break;
+                    case 'c': ins.type = Cosine; break;
+                    case 't': ins.type = Tangent; break;
+                    case 'a': ins.type = Absolute; break;
+                    case 'r': ins.type = SquareRoot; break;
+                    case 'p': ins.type = Power; break;
+                    default: ins.type = Invalid;
+                }
+            } break;
+
+            default: ins.type = Invalid;
+        }
+        if(ins.type == Invalid) {
+            // an instruction that is cut off by the end of the expression is reported at its first character
+            if(p->strings[i] == '\0') { ins.position = i - 1; }
+            program_push(p, ins);
+            return barrier;
+        }
+        program_push(p, ins);
+        optimize_fold(p, barrier);
+        i += 1;
+    }
+    return barrier;
+}
+
+Program compile(char* expression) {
+    Program p = program_new();
+    Compiler c = { .program = &p };
+    size_t e = program_add_string(&p, expression, strlen(expression));
+    compile_expression(&c, e, 0);
+    intern_free(&c.interned);
+    return p;
+}
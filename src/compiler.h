@@ -0,0 +1,10 @@
+#pragma once
+
+#include "runtime.h"
+
+
+// has to be increased whenever the instructions compile() produces for the same source change
+// (including changes to the optimizer), since cached programs are executed without compiling them again
+#define COMPILER_VERSION 1
+
+Program compile(char* expression);
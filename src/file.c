@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "file.h"
+
+
+// reads the entire file into a null-terminated string
+char* file_read(char* path) {
+    FILE* f = fopen(path, "rb");
+    if(f == NULL) { return NULL; }
+    size_t content_ms = 4096;
+    char* content = malloc(content_ms + 1);
+    size_t ci = 0;
+    for(;;) {
+        ci += fread(content + ci, 1, content_ms - ci, f);
+        if(ci < content_ms) { break; }
+        content_ms *= 2;
+        content = realloc(content, content_ms + 1);
+    }
+    fclose(f);
+    content[ci] = '\0';
+    return content;
+}
+
+// maps the entire file into memory (read-only)
+char* file_map(char* path, size_t* size) {
+#ifdef _WIN32
+    FILE* f = fopen(path, "rb");
+    if(f == NULL) { return NULL; }
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* data = length > 0? malloc(length) : NULL;
+    if(data != NULL && fread(data, 1, length, f) != (size_t) length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = length;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) { return NULL; }
+    struct stat st;
+    char* data = NULL;
+    if(fstat(fd, &st) == 0 && st.st_size > 0) {
+        data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) { data = NULL; }
+        *size = st.st_size;
+    }
+    close(fd);
+    return data;
+#endif
+}
+
+void file_unmap(char* data, size_t size) {
+#ifdef _WIN32
+    (void) size;
+    free(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+// opens a new, uniquely named temporary file next to the file at the given path (see 'file_commit')
+FILE* file_create(char* path, char** temporary) {
+    *temporary = malloc(strlen(path) + 7 + 1);
+    sprintf(*temporary, "%s.XXXXXX", path);
+#ifdef _WIN32
+    FILE* f = _mktemp(*temporary) != NULL? fopen(*temporary, "wb") : NULL;
+#else
+    FILE* f = NULL;
+    int fd = mkstemp(*temporary);
+    if(fd >= 0) {
+        // mkstemp only allows the owner to access the file, it gets the permissions 'fopen' would have given it instead
+        mode_t mask = umask(0);
+        umask(mask);
+        fchmod(fd, 0666 & ~mask);
+        f = fdopen(fd, "wb");
+        if(f == NULL) {
+            close(fd);
+            remove(*temporary);
+        }
+    }
+#endif
+    if(f == NULL) {
+        free(*temporary);
+        *temporary = NULL;
+    }
+    return f;
+}
+
+// closes the temporary file and replaces the file at the given path with it, so that the file is never left partially written.
+// if writing the temporary file failed (or 'failed' is set), the temporary file is removed instead. returns 0 on success.
+int file_commit(FILE* f, char* temporary, char* path, int failed) {
+    failed |= fclose(f) != 0;
+#ifdef _WIN32
+    failed = failed || !MoveFileExA(temporary, path, MOVEFILE_REPLACE_EXISTING);
+#else
+    failed = failed || rename(temporary, path) != 0;
+#endif
+    if(failed) { remove(temporary); }
+    free(temporary);
+    return failed;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+char* file_read(char* path);
+char* file_map(char* path, size_t* size);
+void file_unmap(char* data, size_t size);
+FILE* file_create(char* path, char** temporary);
+int file_commit(FILE* f, char* temporary, char* path, int failed);
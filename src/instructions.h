@@ -0,0 +1,71 @@
+#pragma once
+
+#include "runtime.h"
+
+
+// every instruction (except for pushing constants and jumping) is executed by one of these.
+// errors are reported at 'i_ptr' inside of 'expression', exactly as by the interpreter.
+
+void instruction_copy(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_remove(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_swap(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_to_secondary(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_to_primary(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_input(Stack* primary);
+void instruction_print(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_add(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_subtract(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_multiply(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_divide(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_modulo(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_less(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_greater(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_equal(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_and(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_or(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_branch(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr);
+void instruction_loop(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr);
+int instruction_condition(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_array_create(Stack* primary);
+void instruction_array_push(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_array_get(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_array_set(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_array_remove(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_array_length(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_reset(Stack* primary, Stack* secondary);
+void instruction_print_raw(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_debug(Stack* primary, Stack* secondary);
+void instruction_primary_size(Stack* primary);
+void instruction_secondary_size(Stack* primary, Stack* secondary);
+void instruction_snapshot_write(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_snapshot_read(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_string_merge(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_substring(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_string_length(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_random_float(Stack* primary, Random* rng);
+void instruction_random_seed(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr);
+void instruction_random_floats(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr);
+void instruction_random_ints(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr);
+
+void instruction_to_float(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_round_up(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_round_down(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_round_nearest(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_sine(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_cosine(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_tangent(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_absolute(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_square_root(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_power(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+
+void instruction_invalid(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
+void instruction_unclosed_string(Stack* primary, Stack* secondary, char* expression, char* i_ptr);
@@ -0,0 +1,52 @@
+#include <string.h>
+
+#include "intern.h"
+
+
+// FNV-1a
+uint64_t hash_bytes(char* data, size_t size) {
+    uint64_t h = 0xCBF29CE484222325;
+    for(size_t c = 0; c < size; c += 1) {
+        h = (h ^ (unsigned char) data[c]) * 0x100000001B3;
+    }
+    return h;
+}
+
+
+static void intern_insert(InternTable* t, char* strings, size_t offset) {
+    char* s = strings + offset;
+    size_t i = hash_bytes(s, strlen(s)) & (t->malloc_size - 1);
+    while(t->offsets[i] != 0) { i = (i + 1) & (t->malloc_size - 1); }
+    t->offsets[i] = offset + 1;
+}
+
+// returns the offset of the string that is equal to the given one (which does not need to be null-terminated), or INTERN_MISSING
+size_t intern_find(InternTable* t, char* strings, size_t strings_size, char* s, size_t length) {
+    if(t->malloc_size == 0) { return INTERN_MISSING; }
+    size_t i = hash_bytes(s, length) & (t->malloc_size - 1);
+    while(t->offsets[i] != 0) {
+        size_t o = t->offsets[i] - 1;
+        if(o + length < strings_size && strings[o + length] == '\0' && memcmp(strings + o, s, length) == 0) { return o; }
+        i = (i + 1) & (t->malloc_size - 1);
+    }
+    return INTERN_MISSING;
+}
+
+// adds the string at the given offset inside of the strings (which may have moved since the last call)
+void intern_add(InternTable* t, char* strings, size_t offset) {
+    if((t->size + 1) * 2 > t->malloc_size) {
+        InternTable grown = { .size = t->size, .malloc_size = t->malloc_size == 0? 64 : t->malloc_size * 2 };
+        grown.offsets = calloc(grown.malloc_size, sizeof(size_t));
+        for(size_t o = 0; o < t->malloc_size; o += 1) {
+            if(t->offsets[o] != 0) { intern_insert(&grown, strings, t->offsets[o] - 1); }
+        }
+        free(t->offsets);
+        *t = grown;
+    }
+    intern_insert(t, strings, offset);
+    t->size += 1;
+}
+
+void intern_free(InternTable* t) {
+    free(t->offsets);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdlib.h>
+#include <stdint.h>
+
+
+uint64_t hash_bytes(char* data, size_t size);
+
+
+// open addressing table of the offsets (plus one, zero marks an empty slot) of null-terminated strings inside of a growing buffer
+typedef struct InternTable {
+    size_t* offsets;
+    size_t size;
+    size_t malloc_size;
+} InternTable;
+
+#define INTERN_MISSING SIZE_MAX
+
+size_t intern_find(InternTable* t, char* strings, size_t strings_size, char* s, size_t length);
+void intern_add(InternTable* t, char* strings, size_t offset);
+void intern_free(InternTable* t);
@@ -1,18 +1,90 @@
-
 #include <stdio.h>
 #include <string.h>
-#include <time.h>
 
 #include "runtime.h"
+#include "options.h"
+#include "compiler.h"
+#include "aot.h"
+#include "file.h"
+#include "cache.h"
 
 int main(int argc, char** argv) {
-    srand(time(NULL));
+    Options options = options_new();
+    char* output = NULL;
+    char* file = NULL;
+    char* cache_directory = NULL;
+    int use_cache = 1;
+    for(int a = 1; a < argc; a += 1) {
+        int parsed = options_parse(&options, argc, argv, &a);
+        if(parsed < 0) { return 1; }
+        if(parsed > 0) { continue; }
+        if(strcmp(argv[a], "-c") == 0 && a + 1 < argc) {
+            output = argv[a + 1];
+            a += 1;
+        } else if(strcmp(argv[a], "-C") == 0 && a + 1 < argc) {
+            cache_directory = argv[a + 1];
+            a += 1;
+        } else if(strcmp(argv[a], "-n") == 0) {
+            use_cache = 0;
+        } else if(file == NULL && argv[a][0] != '-') {
+            file = argv[a];
+        } else {
+            printf("Usage: %s " OPTIONS_USAGE " [-c <output>] [-C <cache directory>] [-n] [file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    char* source = NULL;
+    if(file != NULL) {
+        source = file_read(file);
+        if(source == NULL) {
+            printf("[Error] the file '%s' could not be read\n", file);
+            return 1;
+        }
+    }
+    if(output != NULL) {
+        if(source == NULL) {
+            printf("[Error] compiling to C requires a file\n");
+            return 1;
+        }
+        Program program = compile(source);
+        int failed = aot_write(output, &program);
+        program_free(&program);
+        free(source);
+        if(failed) {
+            printf("[Error] the file '%s' could not be written\n", output);
+            return 1;
+        }
+        return 0;
+    }
 
-    Stack p = stack_new();
-    Stack s = stack_new();
-    interpret(&p, &s, "(1)((> )Ip1,?)@");
+    Random r;
+    Stack p;
+    Stack s;
+    if(options_apply(&options, &p, &s, &r)) { return 1; }
+    if(source != NULL) {
+        // the compiled program is loaded from the cache if the source has not changed since it was written
+        char* path = use_cache? cache_path(file, cache_directory, source) : NULL;
+        Cache cache;
+        int cached = path != NULL && cache_open(path, source, &cache) == 0;
+        Program program;
+        if(cached) {
+            program = cache.program;
+        } else {
+            program = compile(source);
+            // not being able to write the cache is not an error
+            if(path != NULL) { cache_write(path, source, &program); }
+        }
+        program_execute(&program, &p, &s, &r);
+        if(cached) { cache_close(&cache); }
+        else { program_free(&program); }
+        free(path);
+        free(source);
+    } else {
+        interpret(&p, &s, &r, "(1)((> )Ip1,?)@");
+    }
     stack_free(&p);
     stack_free(&s);
 
     return 0;
-}
\ No newline at end of file
+}
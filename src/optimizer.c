@@ -0,0 +1,57 @@
+#include <limits.h>
+
+#include "optimizer.h"
+
+
+// if the last instruction is an arithmetic, comparison or logical operation on two constants, replace all three with the result.
+// instructions before 'barrier' may be jumped to or over and therefore never get folded.
+void optimize_fold(Program* p, size_t barrier) {
+    if(p->size < barrier + 3) { return; }
+    Instruction* op = &p->instructions[p->size - 1];
+    switch(op->type) {
+        case Add: case Subtract: case Multiply: case Divide: case Modulo:
+        case Less: case Greater: case Equal:
+        case And: case Or: break;
+        default: return;
+    }
+    Instruction* a = &p->instructions[p->size - 3];
+    Instruction* b = &p->instructions[p->size - 2];
+    if(a->type != PushInt && a->type != PushFloat) { return; }
+    if(b->type != PushInt && b->type != PushFloat) { return; }
+    // divisions by zero need to be reported (and overflowing divisions need to fail) at runtime
+    if((op->type == Divide || op->type == Modulo) && b->type == PushInt) {
+        if(b->value.i == 0) { return; }
+        if(b->value.i == -1 && a->type == PushInt && a->value.i == LONG_MIN) { return; }
+    }
+    // evaluate the operation using the same instruction that would be executed at runtime
+    Stack primary = stack_new();
+    Stack secondary = stack_new();
+    stack_push(&primary, a->type == PushInt? value_int(a->value.i) : value_float(a->value.f));
+    stack_push(&primary, b->type == PushInt? value_int(b->value.i) : value_float(b->value.f));
+    program_step(p, p->size - 1, &primary, &secondary, NULL);
+    Value* r = stack_get(&primary, 0);
+    if(r->type == Int) {
+        a->type = PushInt;
+        a->value.i = r->value.i;
+    } else {
+        a->type = PushFloat;
+        a->value.f = r->value.f;
+    }
+    p->size -= 2;
+    stack_free(&primary);
+    stack_free(&secondary);
+}
+
+// returns 1 if the instruction at the given index pushes a constant and writes whether it is truthy, otherwise returns 0
+int optimize_constant(Program* p, size_t i, int* truthy) {
+    Instruction* c = &p->instructions[i];
+    Value v;
+    switch(c->type) {
+        case PushInt: v = value_int(c->value.i); break;
+        case PushFloat: v = value_float(c->value.f); break;
+        case PushString: v = (Value) { .type = String, .value = { .s = p->strings + c->value.s } }; break;
+        default: return 0;
+    }
+    *truthy = value_truthy(&v);
+    return 1;
+}
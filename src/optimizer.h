@@ -0,0 +1,7 @@
+#pragma once
+
+#include "runtime.h"
+
+
+void optimize_fold(Program* p, size_t barrier);
+int optimize_constant(Program* p, size_t i, int* truthy);
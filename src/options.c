@@ -0,0 +1,47 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "options.h"
+#include "snapshot.h"
+
+
+Options options_new() {
+    return (Options) { .seed = (uint64_t) time(NULL), .snapshot = NULL };
+}
+
+// parses the option at index 'a' (moving 'a' past its value), returns 1 if it is one of the shared options,
+// 0 if it is not and -1 if its value is invalid
+int options_parse(Options* o, int argc, char** argv, int* a) {
+    if(strcmp(argv[*a], "-s") == 0 && *a + 1 < argc) {
+        char* value = argv[*a + 1];
+        char* end;
+        o->seed = strtoull(value, &end, 10);
+        if(*value == '\0' || *end != '\0') {
+            printf("[Error] '%s' is not a valid seed\n", value);
+            return -1;
+        }
+        *a += 1;
+        return 1;
+    }
+    if(strcmp(argv[*a], "-l") == 0 && *a + 1 < argc) {
+        o->snapshot = argv[*a + 1];
+        *a += 1;
+        return 1;
+    }
+    return 0;
+}
+
+// seeds the random number generator and creates both stacks (with the contents of the snapshot if one was given), returns 0 on success
+int options_apply(Options* o, Stack* primary, Stack* secondary, Random* rng) {
+    *rng = random_new(o->seed);
+    *primary = stack_new();
+    *secondary = stack_new();
+    if(o->snapshot != NULL && snapshot_read(o->snapshot, primary, secondary)) {
+        printf("[Error] the snapshot '%s' could not be read\n", o->snapshot);
+        stack_free(primary);
+        stack_free(secondary);
+        return 1;
+    }
+    return 0;
+}
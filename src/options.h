@@ -0,0 +1,16 @@
+#pragma once
+
+#include "runtime.h"
+
+
+// the options shared by the interpreter and programs compiled to C
+typedef struct Options {
+    uint64_t seed;
+    char* snapshot;
+} Options;
+
+#define OPTIONS_USAGE "[-s <seed>] [-l <snapshot>]"
+
+Options options_new();
+int options_parse(Options* o, int argc, char** argv, int* a);
+int options_apply(Options* o, Stack* primary, Stack* secondary, Random* rng);
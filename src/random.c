@@ -0,0 +1,47 @@
+#include "random.h"
+
+
+// xoshiro256** (https://prng.di.unimi.it/), seeded using splitmix64
+
+static uint64_t splitmix64(uint64_t* x) {
+    *x += 0x9E3779B97F4A7C15;
+    uint64_t z = *x;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+Random random_new(uint64_t seed) {
+    Random r;
+    random_seed(&r, seed);
+    return r;
+}
+void random_seed(Random* r, uint64_t seed) {
+    for(int i = 0; i < 4; i += 1) {
+        r->state[i] = splitmix64(&seed);
+    }
+}
+uint64_t random_next(Random* r) {
+    uint64_t* s = r->state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+// greater or equal to 0 and less than 1, using the upper 53 bits
+double random_float(Random* r) { return (random_next(r) >> 11) * 0x1.0p-53; }
+// greater or equal to 0 and less than 'bound' (rejects values that would bias the modulo)
+uint64_t random_below(Random* r, uint64_t bound) {
+    uint64_t threshold = -bound % bound;
+    for(;;) {
+        uint64_t x = random_next(r);
+        if(x >= threshold) { return x % bound; }
+    }
+}
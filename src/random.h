@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+
+typedef struct Random {
+    uint64_t state[4];
+} Random;
+
+Random random_new(uint64_t seed);
+void random_seed(Random* r, uint64_t seed);
+uint64_t random_next(Random* r);
+double random_float(Random* r);
+uint64_t random_below(Random* r, uint64_t bound);
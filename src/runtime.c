@@ -2,19 +2,20 @@
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
+#include <stdint.h>
 
 #include "runtime.h"
+#include "instructions.h"
 #include "error.h"
+#include "compiler.h"
+#include "snapshot.h"
 
 
-Value value_int(long int v) { return (Value) { .type = Int, .value = { .i = v } }; }
-Value value_float(double v) { return (Value) { .type = Float, .value = { .f = v } }; }
 Value value_string(char* v) {
     Value n = (Value) { .type = String, .value = { .s = malloc(strlen(v) + 1) } };
     strcpy(n.value.s, v);
     return n;
 }
-Value value_array(Stack* v) { return (Value) { .type = Array, .value = { .a = v } }; }
 Value value_copy(Value* v) {
     Value c;
     memcpy(&c, v, sizeof(Value));
@@ -56,6 +57,15 @@ void value_free(Value* v) {
         } break;
     }
 }
+int value_truthy(Value* v) {
+    switch(v->type) {
+        case Int: return v->value.i != 0;
+        case Float: return v->value.i != 0.0;
+        case String: return strlen(v->value.s) != 0;
+        case Array: return v->value.a->size != 0;
+    }
+    return 0;
+}
 
 
 Stack stack_new() {
@@ -65,19 +75,6 @@ Stack stack_new() {
     s.values = malloc(s.malloc_size * sizeof(Value));
     return s;
 }
-void stack_push(Stack* s, Value v) {
-    s->size += 1;
-    if(s->size > s->malloc_size) {
-        s->malloc_size *= 2;
-        s->values = realloc(s->values, s->malloc_size * sizeof(Value));
-    }
-    stack_set(s, s->size - 1, v);
-}
-inline void stack_set(Stack* s, size_t i, Value v) {
-    memcpy(&s->values[i], &v, sizeof(Value));
-}
-inline Value* stack_get(Stack* s, size_t i) { return &s->values[i]; }
-inline void stack_pop(Stack* s) { s->size -= 1; }
 void stack_free(Stack* s) {
     for(size_t v = 0; v < s->size; v += 1) {
         value_free(stack_get(s, v));
@@ -86,6 +83,50 @@ void stack_free(Stack* s) {
 }
 
 
+#define INSTRUCTION_TYPE_NAME(name) #name,
+char* instruction_names[] = { INSTRUCTION_TYPES(INSTRUCTION_TYPE_NAME) };
+size_t instruction_count = sizeof(instruction_names) / sizeof(char*);
+
+Program program_new() {
+    Program p;
+    p.malloc_size = 16;
+    p.size = 0;
+    p.instructions = malloc(p.malloc_size * sizeof(Instruction));
+    p.strings_malloc_size = 256;
+    p.strings_size = 0;
+    p.strings = malloc(p.strings_malloc_size);
+    return p;
+}
+void program_push(Program* p, Instruction i) {
+    p->size += 1;
+    if(p->size > p->malloc_size) {
+        p->malloc_size *= 2;
+        p->instructions = realloc(p->instructions, p->malloc_size * sizeof(Instruction));
+    }
+    p->instructions[p->size - 1] = i;
+}
+// copies the string into the program strings (adding a null terminator) and returns its offset
+size_t program_add_string(Program* p, char* s, size_t length) {
+    size_t offset = p->strings_size;
+    p->strings_size += length + 1;
+    if(p->strings_size > p->strings_malloc_size) {
+        // the string may be a part of the program strings itself
+        int inside = s >= p->strings && s < p->strings + offset;
+        size_t s_offset = s - p->strings;
+        while(p->strings_size > p->strings_malloc_size) { p->strings_malloc_size *= 2; }
+        p->strings = realloc(p->strings, p->strings_malloc_size);
+        if(inside) { s = p->strings + s_offset; }
+    }
+    memcpy(p->strings + offset, s, length);
+    p->strings[offset + length] = '\0';
+    return offset;
+}
+void program_free(Program* p) {
+    free(p->instructions);
+    free(p->strings);
+}
+
+
 #define INVALID_INSTRUCTION_FMT(c) "'%c' is not a valid instruction!", c
 
 #define GET_INFIX_ARGS()\
@@ -106,544 +147,584 @@ void stack_free(Stack* s) {
     value_free(&a);\
     value_free(&b);
 
-void interpret(Stack* primary, Stack* secondary, char* expression) {
-    char* i_ptr = expression;
-    while(*i_ptr != '\0') {
-        switch(*i_ptr) {
-            // no op
-            case ' ': case '\n': break;
-
-            // push number onto primary stack
-            case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': {
-                char* start = i_ptr;
-                while('0' <= *i_ptr && *i_ptr <= '9') {
-                    i_ptr += 1;
-                }
-                int is_float = 0;
-                if(i_ptr != start && *i_ptr == '.' && '0' <= *(i_ptr + 1) && *(i_ptr + 1) <= '9') {
-                    i_ptr += 1;
-                    is_float = 1;
-                }
-                while('0' <= *i_ptr && *i_ptr <= '9') {
-                    i_ptr += 1;
-                }
-                size_t number_length = i_ptr - start;
-                char number[number_length + 1];
-                memcpy(number, start, number_length);
-                number[number_length] = '\0';
-                if(is_float) {
-                    stack_push(primary, value_float(strtod(number, NULL)));
-                } else {
-                    stack_push(primary, value_int(strtol(number, NULL, 10)));
-                }
-                i_ptr -= 1; // will be increased again after the switch
-            } break;
-            // push paren content onto primary stack
-            case '(': {
-                i_ptr += 1;
-                char* start = i_ptr;
-                int scope = 1;
-                while(scope != 1 || *i_ptr != ')') {
-                    if(*i_ptr == '(') { scope += 1; }
-                    if(*i_ptr == ')') { scope -= 1; }
-                    i_ptr += 1;
-                    if(*i_ptr == '\0') { report_error("unclosed string literal", primary, secondary, expression, i_ptr); }
-                }
-                size_t string_length = i_ptr - start;
-                char* string = malloc(string_length + 1);
-                memcpy(string, start, string_length);
-                string[string_length] = '\0';
-                stack_push(primary, value_string(string));
-                // will be increased again after the switch
-            } break;
-
-            // push a copy of the top primary stack item onto the primary stack
-            case ':': {
-                if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                stack_push(primary, value_copy(stack_get(primary, primary->size - 1)));
-            } break;
-            // pop the top item off the primary stack
-            case '^': {
-                if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                value_free(stack_get(primary, primary->size - 1));
-                stack_pop(primary);
-            } break;
-            // swap the top two items on the primary stack
-            case '$': {
-                if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                Value a = *stack_get(primary, primary->size - 1);
-                Value b = *stack_get(primary, primary->size - 2);
-                stack_set(primary, primary->size - 1, b);
-                stack_set(primary, primary->size - 2, a);
-            } break;
-            // pop the top item off the primary stack and push it onto the secondary stack
-            case '#': {
-                if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                Value moved = *stack_get(primary, primary->size - 1);
-                stack_pop(primary);
-                stack_push(secondary, moved);
-            } break;
-            // pop the top item off the secondary stack and push it onto the primary stack
-            case '\'': {
-                if(secondary->size < 1) { report_error("the secondary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                Value moved = *stack_get(secondary, secondary->size - 1);
-                stack_pop(secondary);
-                stack_push(primary, moved);
-            } break;
-
-            // receive text as input and push it onto the primary stack
-            case ',': {
-                int content_ms = 64;
-                char* content = malloc(content_ms + 1);
-                int ci = 0;
-                for(;;) {
-                    int c = fgetc(stdin);
-                    if(c == EOF || c == '\n') { break; }
-                    if(ci >= content_ms) {
-                        content_ms *= 2;
-                        content = realloc(content, content_ms + 1);
-                    }
-                    content[ci] = c;
-                    ci += 1;
-                }
-                content = realloc(content, ci + 1);
-                content[ci] = '\0';
-                stack_push(primary, value_string(content));
-            } break;
-            // pop the top item off the primary stack and print it
-            case '!': {
-                if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                Value v = *stack_get(primary, primary->size - 1);
-                stack_pop(primary);
-                value_print(&v);
-                printf("\n");
-                value_free(&v);
-            } break;
-
-            // pop the top two stack items off the primary stack and push their sum onto the primary stack
-            case '+': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(+)
-            } break;
-            // pop the top two stack items off the primary stack and push their difference onto the primary stack
-            case '-': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(-)
-            } break;
-            // pop the top two stack items off the primary stack and push their product onto the primary stack
-            case '*': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(*)
-            } break;
-            // pop the top two stack items off the primary stack and push their quotient onto the primary stack
-            case '/': {
-                GET_INFIX_ARGS()
-                if(b.type == Int && b.value.i == 0) { report_error("integer division by zero", primary, secondary, expression, i_ptr); }
-                NUMBER_INFIX_OP(/)
-            } break;
-            // pop the top two stack items off the primary stack and push their remainder onto the primary stack
-            case '%': {
-                if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                Value b = *stack_get(primary, primary->size - 1);
-                stack_pop(primary);
-                Value a = *stack_get(primary, primary->size - 1);
-                stack_pop(primary);
-                if(b.type != Int && b.type != Float) { report_error("the first item is not a number", primary, secondary, expression, i_ptr); }
-                if(a.type != Int && a.type != Float) { report_error("the second item is not a number", primary, secondary, expression, i_ptr); }
-                if(a.type == Float || b.type == Float) {
-                    stack_push(primary, value_float(fmod(a.type == Float? a.value.f : a.value.i, b.type == Float? b.value.f : b.value.i)));
-                } else {
-                    stack_push(primary, value_int(a.value.i % b.value.i));
-                }
-                value_free(&a);
-                value_free(&b);
-            } break;
-
-            // pop the top two stack items off the primary stack. if the first is less than the second, push 1 (otherwise 0) onto the primary stack.
-            case '<': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(<)
-            } break;
-            // pop the top two stack items off the primary stack. if the first is greater than the second, push 1 (otherwise 0) onto the primary stack.
-            case '>': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(>)
-            } break;
-            // pop the top two stack items off the primary stack. if they are equal, push 1 (otherwise 0) onto the primary stack.
-            case '=': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(==)
-            } break;
-
-            // pop the top two stack items off the primary stack. if both are truthy, push 1 (otherwise 0) onto the primary stack.
-            case '&': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(&&)
-            } break;
-            // pop the top two stack items off the primary stack. if at least one of them is truthy, push 1 (otherwise 0) onto the primary stack.
-            case '|': {
-                GET_INFIX_ARGS()
-                NUMBER_INFIX_OP(||)
-            } break;
-
-            // pop the top item off the primary stack. if the (now) top stack item is truthy, evaluate the popped expression.
-            case '?': {
-                if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                Value e = *stack_get(primary, primary->size - 1);
-                Value cv = *stack_get(primary, primary->size - 2);
-                if(e.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
-                stack_pop(primary);
-                stack_pop(primary);
-                int truthy = 0;
-                switch(cv.type) {
-                    case Int: truthy = cv.value.i != 0; break;
-                    case Float: truthy = cv.value.i != 0.0; break;
-                    case String: truthy = strlen(cv.value.s) != 0; break;
-                    case Array: truthy = cv.value.a->size != 0; break;
-                }
-                value_free(&cv);
-                if(truthy) {
-                    interpret(primary, secondary, e.value.s);
-                }
-                value_free(&e);
-            } break;
-            // pop the top item off the primary stack. repeatedly evaluate the popped expression while the (now) top stack item is truthy.
-            case '@': {
-                if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                Value e = *stack_get(primary, primary->size - 1);
-                Value c = *stack_get(primary, primary->size - 2);
-                if(e.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
-                if(c.type != String) { report_error("the second item is not a string", primary, secondary, expression, i_ptr); }
-                stack_pop(primary);
-                stack_pop(primary);
-                for(;;) {
-                    interpret(primary, secondary, c.value.s);
-                    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                    Value cv = *stack_get(primary, primary->size - 1);
-                    stack_pop(primary);
-                    int truthy = 0;
-                    switch(cv.type) {
-                        case Int: truthy = cv.value.i != 0; break;
-                        case Float: truthy = cv.value.i != 0.0; break;
-                        case String: truthy = strlen(cv.value.s) != 0; break;
-                        case Array: truthy = cv.value.a->size != 0; break;
-                    }
-                    if(!truthy) {
-                        break;
-                    }
-                    value_free(&cv);
-                    interpret(primary, secondary, e.value.s);
-                }
-                value_free(&e);
-                value_free(&c);
-            } break;
-
-            // array-related instruction
-            case 'A': {
-                i_ptr += 1;
-                int b = 1;
-                switch(*i_ptr) {
-                    // *c*reate array
-                    case 'c': {
-                        Stack* c = malloc(sizeof(Stack));
-                        *c = stack_new();
-                        stack_push(primary, value_array(c));
-                    } break;
-                    // *p*ush onto array
-                    case 'p': {
-                        if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value v = *stack_get(primary, primary->size - 1);
-                        Value* a = stack_get(primary, primary->size - 2);
-                        if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        stack_push(a->value.a, v);
-                    } break;
-                    // *g*et array index
-                    case 'g': {
-                        if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value i = *stack_get(primary, primary->size - 1);
-                        Value* a = stack_get(primary, primary->size - 2);
-                        if(i.type != Int) { report_error("the first item is not in integer", primary, secondary, expression, i_ptr); }
-                        if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
-                        if(i.value.i < 0 || (size_t) i.value.i >= a->value.a->size) { report_error("the index is out of bounds", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        stack_push(primary, value_copy(stack_get(a->value.a, i.value.i)));
-                    } break;
-                    // *s*et array index
-                    case 's': {
-                        if(primary->size < 3) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value v = *stack_get(primary, primary->size - 1);
-                        Value i = *stack_get(primary, primary->size - 2);
-                        Value* a = stack_get(primary, primary->size - 3);
-                        if(i.type != Int) { report_error("the first item is not in integer", primary, secondary, expression, i_ptr); }
-                        if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
-                        if(i.value.i < 0 || (size_t) i.value.i >= a->value.a->size) { report_error("the index is out of bounds", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        stack_pop(primary);
-                        stack_set(a->value.a, i.value.i, v);
-                    } break;
-                    // *r*emove array index
-                    case 'r': {
-                        if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value i = *stack_get(primary, primary->size - 1);
-                        Value* a = stack_get(primary, primary->size - 2);
-                        if(i.type != Int) { report_error("the first item is not in integer", primary, secondary, expression, i_ptr); }
-                        if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
-                        if(i.value.i < 0 || (size_t) i.value.i >= a->value.a->size) { report_error("the index is out of bounds", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        for(size_t v = i.value.i + 1; v < a->value.a->size; v += 1) {
-                            stack_set(a->value.a, v - 1, *stack_get(a->value.a, v));
-                        }
-                        stack_pop(a->value.a);
-                    } break;
-                    // *l*ength of array
-                    case 'l': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* a = stack_get(primary, primary->size - 1);
-                        if(a->type != Array) { report_error("the first item is not an array", primary, secondary, expression, i_ptr); }
-                        stack_push(primary, value_int(a->value.a->size));
-                    } break;
-
-                    default: b = 0;
-                }
-                if(b) { break; }
-            }
-            // fall through
-
-            // interpreter-related instruction
-            case 'I': {
-                i_ptr += 1;
-                int b = 1;
-                switch(*i_ptr) {
-                    // *r*eset the stacks
-                    case 'r': {
-                        stack_free(primary);
-                        stack_free(secondary);
-                        *primary = stack_new();
-                        *secondary = stack_new();
-                    } break;
-                    // *p*rint raw string
-                    case 'p': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value s = *stack_get(primary, primary->size - 1);
-                        if(s.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        printf("%s", s.value.s);
-                        value_free(&s);
-                    } break;
-                    // print *d*ebug information
-                    case 'd': {
-                        printf("[Stack]");
-                        printf("\nprimary:");
-                        if(primary->size > 0) {
-                            for(size_t v = 0; v < primary->size; v += 1) {
-                                printf(" [%ld] ", v);
-                                value_print(stack_get(primary, v));
-                            }
-                        } else {
-                            printf(" <empty>");
-                        }
-                        printf("\nsecondary:");
-                        if(secondary->size > 0) {
-                            for(size_t v = 0; v < secondary->size; v += 1) {
-                                printf(" [%ld] ", v);
-                                value_print(stack_get(secondary, v));
-                            }
-                        } else {
-                            printf(" <empty>");
-                        }
-                        printf("\n");
-                    } break;
-                    // push *p*rimary stack size (before call) onto the primary stack
-                    case 'P': {
-                        stack_push(primary, value_int(primary->size));
-                    } break;
-                    // push *s*econdary stack size onto the primary stack
-                    case 'S': {
-                        stack_push(primary, value_int(secondary->size));
-                    } break;
-
-                    default: b = 0;
-                }
-                if(b) { break; }
-            }
-            // fall through
-
-            // string-related instruction
-            case 'S': {
-                i_ptr += 1;
-                int b = 1;
-                switch(*i_ptr) {
-                    // *m*erge strings
-                    case 'm': {
-                        if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value b = *stack_get(primary, primary->size - 1);
-                        Value a = *stack_get(primary, primary->size - 2);
-                        if(b.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
-                        if(a.type != String) { report_error("the second item is not a string", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        stack_pop(primary);
-                        size_t a_length = strlen(a.value.s);
-                        size_t b_length = strlen(b.value.s);
-                        char* merged = malloc(a_length + b_length + 1);
-                        memcpy(merged,            a.value.s, a_length);
-                        memcpy(merged + a_length, b.value.s, b_length);
-                        merged[a_length + b_length] = '\0';
-                        value_free(&b);
-                        value_free(&a);
-                        stack_push(primary, value_string(merged));
-                    } break;
-                    // create *s*ubstring copy
-                    case 's': {
-                        if(primary->size < 3) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value end = *stack_get(primary, primary->size - 1);
-                        Value start = *stack_get(primary, primary->size - 2);
-                        Value* s = stack_get(primary, primary->size - 3);
-                        if(start.type != Int) { report_error("the first item is not an integer", primary, secondary, expression, i_ptr); }
-                        if(end.type != Int) { report_error("the second item is not an integer", primary, secondary, expression, i_ptr); }
-                        if(s->type != String) { report_error("the third item is not a string", primary, secondary, expression, i_ptr); }
-                        size_t s_length = strlen(s->value.s);
-                        if(start.value.i < 0 || (size_t) start.value.i >= s_length) { report_error("the start index is out of bounds", primary, secondary, expression, i_ptr); }
-                        if(end.value.i < 0 || (size_t) end.value.i >= s_length) { report_error("the end index is out of bounds", primary, secondary, expression, i_ptr); }
-                        if(end.value.i < start.value.i) { report_error("the end index is smaller than the start index", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        stack_pop(primary);
-                        size_t sub_length = end.value.i - start.value.i;
-                        char* sub = malloc(sub_length + 1);
-                        memcpy(sub, s->value.s + start.value.i, sub_length);
-                        sub[sub_length] = '\0';
-                        stack_push(primary, value_string(sub));
-                    } break;
-                    // get string *l*ength
-                    case 'l': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* s = stack_get(primary, primary->size - 1);
-                        if(s->type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
-                        stack_push(primary, value_int(strlen(s->value.s)));
-                    } break;
-
-                    default: b = 0;
-                }
-                if(b) { break; }
-            }
-            // fall through
-
-            // math-related instruction
-            case 'M': {
-                i_ptr += 1;
-                int b = 1;
-                switch(*i_ptr) {
-                    // put *P*i onto the stack
-                    case 'P': {
-                        stack_push(primary, value_float(3.14159265358979323846));
-                    } break;
-                    // put *T*au onto the stack
-                    case 'T': {
-                        stack_push(primary, value_float(6.28318530717958647692));
-                    } break;
-                    // put *E*uler's number onto the stack
-                    case 'E': {
-                        stack_push(primary, value_float(2.7182818284590452354));
-                    } break;
-                    // put a *r*andom number that is greater or equal to 0 and less than 1 onto the stack
-                    case 'R': {
-                        stack_push(primary, value_float((float) rand() / (float) RAND_MAX));
-                    } break;
-                         
-                    // convert integer to *f*loat
-                    case 'f': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Int) { report_error("the first item is not an integer", primary, secondary, expression, i_ptr); }
-                        x->value.f = (float) x->value.i;
-                        x->type = Float;
-                    } break;
-                    // round number at the top of the stack *u*p
-                    case 'u': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        x->value.i = (int) ceil(x->value.f);
-                        x->type = Int;
-                    } break;
-                    // round number at the top of the stack *d*own
-                    case 'd': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        x->value.i = (int) floor(x->value.f);
-                        x->type = Int;
-                    } break;
-                    // round number at the top of the stack to the *n*earest integer
-                    case 'n': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        x->value.i = (int) round(x->value.f);
-                        x->type = Int;
-                    } break;
-                    // calulate the *s*ine of the number at the top of the stack
-                    case 's': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        x->value.f = sin(x->value.f);
-                    } break;
-                    // calculate the *c*osine of the number at the top of the stack
-                    case 'c': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        x->value.f = cos(x->value.f);
-                    } break;
-                    // calculate the *t*angent of the number at the top of the stack
-                    case 't': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        x->value.f = tan(x->value.f);
-                    } break;
-                    // calculate the *a*bsolute value of the number at the top of the stack
-                    case 'a': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        switch(x->type) {
-                            case Int: x->value.i = labs(x->value.i); break;
-                            case Float: x->value.f = fabs(x->value.f); break;
-                            default: report_error("the first item is not an integer or float", primary, secondary, expression, i_ptr);
-                        }
-                    } break;
-                    // calculate the square *r*oot of the number at the top of the stack
-                    case 'r': {
-                        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value* x = stack_get(primary, primary->size - 1);
-                        if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        x->value.f = sqrt(x->value.f);
-                    } break;
-                    // calculate the second number on the stack (top - 1) to the power of the first (top), replace with result
-                    case 'p': {
-                        if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
-                        Value n = *stack_get(primary, primary->size - 1);
-                        Value* x = stack_get(primary, primary->size - 2);
-                        if(n.type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
-                        if(x->type != Float) { report_error("the second item is not a float", primary, secondary, expression, i_ptr); }
-                        stack_pop(primary);
-                        x->value.f = pow(x->value.f, n.value.f);
-                    } break;
+// push a copy of the top primary stack item onto the primary stack
+void instruction_copy(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    stack_push(primary, value_copy(stack_get(primary, primary->size - 1)));
+}
+// pop the top item off the primary stack
+void instruction_remove(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    value_free(stack_get(primary, primary->size - 1));
+    stack_pop(primary);
+}
+// swap the top two items on the primary stack
+void instruction_swap(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value a = *stack_get(primary, primary->size - 1);
+    Value b = *stack_get(primary, primary->size - 2);
+    stack_set(primary, primary->size - 1, b);
+    stack_set(primary, primary->size - 2, a);
+}
+// pop the top item off the primary stack and push it onto the secondary stack
+void instruction_to_secondary(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value moved = *stack_get(primary, primary->size - 1);
+    stack_pop(primary);
+    stack_push(secondary, moved);
+}
+// pop the top item off the secondary stack and push it onto the primary stack
+void instruction_to_primary(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(secondary->size < 1) { report_error("the secondary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value moved = *stack_get(secondary, secondary->size - 1);
+    stack_pop(secondary);
+    stack_push(primary, moved);
+}
+// receive text as input and push it onto the primary stack
+void instruction_input(Stack* primary) {
+    int content_ms = 64;
+    char* content = malloc(content_ms + 1);
+    int ci = 0;
+    for(;;) {
+        int c = fgetc(stdin);
+        if(c == EOF || c == '\n') { break; }
+        if(ci >= content_ms) {
+            content_ms *= 2;
+            content = realloc(content, content_ms + 1);
+        }
+        content[ci] = c;
+        ci += 1;
+    }
+    content = realloc(content, ci + 1);
+    content[ci] = '\0';
+    stack_push(primary, value_string(content));
+    free(content);
+}
+// pop the top item off the primary stack and print it
+void instruction_print(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value v = *stack_get(primary, primary->size - 1);
+    stack_pop(primary);
+    value_print(&v);
+    printf("\n");
+    value_free(&v);
+}
+// pop the top two stack items off the primary stack and push their sum onto the primary stack
+void instruction_add(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(+)
+}
+// pop the top two stack items off the primary stack and push their difference onto the primary stack
+void instruction_subtract(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(-)
+}
+// pop the top two stack items off the primary stack and push their product onto the primary stack
+void instruction_multiply(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(*)
+}
+// pop the top two stack items off the primary stack and push their quotient onto the primary stack
+void instruction_divide(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    if(b.type == Int && b.value.i == 0) { report_error("integer division by zero", primary, secondary, expression, i_ptr); }
+    NUMBER_INFIX_OP(/)
+}
+// pop the top two stack items off the primary stack and push their remainder onto the primary stack
+void instruction_modulo(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value b = *stack_get(primary, primary->size - 1);
+    stack_pop(primary);
+    Value a = *stack_get(primary, primary->size - 1);
+    stack_pop(primary);
+    if(b.type != Int && b.type != Float) { report_error("the first item is not a number", primary, secondary, expression, i_ptr); }
+    if(a.type != Int && a.type != Float) { report_error("the second item is not a number", primary, secondary, expression, i_ptr); }
+    if(a.type == Float || b.type == Float) {
+        stack_push(primary, value_float(fmod(a.type == Float? a.value.f : a.value.i, b.type == Float? b.value.f : b.value.i)));
+    } else {
+        stack_push(primary, value_int(a.value.i % b.value.i));
+    }
+    value_free(&a);
+    value_free(&b);
+}
+// pop the top two stack items off the primary stack. if the first is less than the second, push 1 (otherwise 0) onto the primary stack.
+void instruction_less(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(<)
+}
+// pop the top two stack items off the primary stack. if the first is greater than the second, push 1 (otherwise 0) onto the primary stack.
+void instruction_greater(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(>)
+}
+// pop the top two stack items off the primary stack. if they are equal, push 1 (otherwise 0) onto the primary stack.
+void instruction_equal(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(==)
+}
+// pop the top two stack items off the primary stack. if both are truthy, push 1 (otherwise 0) onto the primary stack.
+void instruction_and(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(&&)
+}
+// pop the top two stack items off the primary stack. if at least one of them is truthy, push 1 (otherwise 0) onto the primary stack.
+void instruction_or(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    GET_INFIX_ARGS()
+    NUMBER_INFIX_OP(||)
+}
+// pop the top item off the primary stack. if the (now) top stack item is truthy, evaluate the popped expression.
+void instruction_branch(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value e = *stack_get(primary, primary->size - 1);
+    Value cv = *stack_get(primary, primary->size - 2);
+    if(e.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    stack_pop(primary);
+    int truthy = value_truthy(&cv);
+    value_free(&cv);
+    if(truthy) {
+        interpret(primary, secondary, rng, e.value.s);
+    }
+    value_free(&e);
+}
+// pop the top item off the primary stack. repeatedly evaluate the popped expression while the (now) top stack item is truthy.
+void instruction_loop(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value e = *stack_get(primary, primary->size - 1);
+    Value c = *stack_get(primary, primary->size - 2);
+    if(e.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
+    if(c.type != String) { report_error("the second item is not a string", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    stack_pop(primary);
+    // both expressions only get compiled once, not on every iteration
+    Program cp = compile(c.value.s);
+    Program ep = compile(e.value.s);
+    for(;;) {
+        program_execute(&cp, primary, secondary, rng);
+        if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+        Value cv = *stack_get(primary, primary->size - 1);
+        stack_pop(primary);
+        int truthy = value_truthy(&cv);
+        value_free(&cv);
+        if(!truthy) {
+            break;
+        }
+        program_execute(&ep, primary, secondary, rng);
+    }
+    program_free(&cp);
+    program_free(&ep);
+    value_free(&e);
+    value_free(&c);
+}
+// pop the top item off the primary stack and return whether it is truthy
+// ('?' and '@' with expressions known at compile time get compiled to this, followed by a jump if it is not)
+int instruction_condition(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value cv = *stack_get(primary, primary->size - 1);
+    stack_pop(primary);
+    int truthy = value_truthy(&cv);
+    value_free(&cv);
+    return truthy;
+}
+// *c*reate array
+void instruction_array_create(Stack* primary) {
+    Stack* c = malloc(sizeof(Stack));
+    *c = stack_new();
+    stack_push(primary, value_array(c));
+}
+// *p*ush onto array
+void instruction_array_push(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value v = *stack_get(primary, primary->size - 1);
+    Value* a = stack_get(primary, primary->size - 2);
+    if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    stack_push(a->value.a, v);
+}
+// *g*et array index
+void instruction_array_get(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value i = *stack_get(primary, primary->size - 1);
+    Value* a = stack_get(primary, primary->size - 2);
+    if(i.type != Int) { report_error("the first item is not in integer", primary, secondary, expression, i_ptr); }
+    if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
+    if(i.value.i < 0 || (size_t) i.value.i >= a->value.a->size) { report_error("the index is out of bounds", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    stack_push(primary, value_copy(stack_get(a->value.a, i.value.i)));
+}
+// *s*et array index
+void instruction_array_set(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 3) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value v = *stack_get(primary, primary->size - 1);
+    Value i = *stack_get(primary, primary->size - 2);
+    Value* a = stack_get(primary, primary->size - 3);
+    if(i.type != Int) { report_error("the first item is not in integer", primary, secondary, expression, i_ptr); }
+    if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
+    if(i.value.i < 0 || (size_t) i.value.i >= a->value.a->size) { report_error("the index is out of bounds", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    stack_pop(primary);
+    stack_set(a->value.a, i.value.i, v);
+}
+// *r*emove array index
+void instruction_array_remove(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value i = *stack_get(primary, primary->size - 1);
+    Value* a = stack_get(primary, primary->size - 2);
+    if(i.type != Int) { report_error("the first item is not in integer", primary, secondary, expression, i_ptr); }
+    if(a->type != Array) { report_error("the second item is not an array", primary, secondary, expression, i_ptr); }
+    if(i.value.i < 0 || (size_t) i.value.i >= a->value.a->size) { report_error("the index is out of bounds", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    for(size_t v = i.value.i + 1; v < a->value.a->size; v += 1) {
+        stack_set(a->value.a, v - 1, *stack_get(a->value.a, v));
+    }
+    stack_pop(a->value.a);
+}
+// *l*ength of array
+void instruction_array_length(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* a = stack_get(primary, primary->size - 1);
+    if(a->type != Array) { report_error("the first item is not an array", primary, secondary, expression, i_ptr); }
+    stack_push(primary, value_int(a->value.a->size));
+}
+// *r*eset the stacks
+void instruction_reset(Stack* primary, Stack* secondary) {
+    stack_free(primary);
+    stack_free(secondary);
+    *primary = stack_new();
+    *secondary = stack_new();
+}
+// *p*rint raw string
+void instruction_print_raw(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value s = *stack_get(primary, primary->size - 1);
+    if(s.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    printf("%s", s.value.s);
+    value_free(&s);
+}
+// print *d*ebug information
+void instruction_debug(Stack* primary, Stack* secondary) {
+    printf("[Stack]");
+    printf("\nprimary:");
+    if(primary->size > 0) {
+        for(size_t v = 0; v < primary->size; v += 1) {
+            printf(" [%ld] ", v);
+            value_print(stack_get(primary, v));
+        }
+    } else {
+        printf(" <empty>");
+    }
+    printf("\nsecondary:");
+    if(secondary->size > 0) {
+        for(size_t v = 0; v < secondary->size; v += 1) {
+            printf(" [%ld] ", v);
+            value_print(stack_get(secondary, v));
+        }
+    } else {
+        printf(" <empty>");
+    }
+    printf("\n");
+}
+// push *p*rimary stack size (before call) onto the primary stack
+void instruction_primary_size(Stack* primary) {
+    stack_push(primary, value_int(primary->size));
+}
+// push *s*econdary stack size onto the primary stack
+void instruction_secondary_size(Stack* primary, Stack* secondary) {
+    stack_push(primary, value_int(secondary->size));
+}
+// *w*rite a snapshot of both stacks to the file at the path in the top primary stack item
+void instruction_snapshot_write(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value path = *stack_get(primary, primary->size - 1);
+    if(path.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    if(snapshot_write(path.value.s, primary, secondary)) {
+        stack_push(primary, path);
+        report_error("the snapshot could not be written", primary, secondary, expression, i_ptr);
+    }
+    value_free(&path);
+}
+// *l*oad the snapshot from the file at the path in the top primary stack item, replacing both stacks
+void instruction_snapshot_read(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value path = *stack_get(primary, primary->size - 1);
+    if(path.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    if(snapshot_read(path.value.s, primary, secondary)) {
+        stack_push(primary, path);
+        report_error("the snapshot could not be read", primary, secondary, expression, i_ptr);
+    }
+    value_free(&path);
+}
+// *m*erge strings
+void instruction_string_merge(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value b = *stack_get(primary, primary->size - 1);
+    Value a = *stack_get(primary, primary->size - 2);
+    if(b.type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
+    if(a.type != String) { report_error("the second item is not a string", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    stack_pop(primary);
+    size_t a_length = strlen(a.value.s);
+    size_t b_length = strlen(b.value.s);
+    char* merged = malloc(a_length + b_length + 1);
+    memcpy(merged,            a.value.s, a_length);
+    memcpy(merged + a_length, b.value.s, b_length);
+    merged[a_length + b_length] = '\0';
+    value_free(&b);
+    value_free(&a);
+    stack_push(primary, value_string(merged));
+    free(merged);
+}
+// create *s*ubstring copy
+void instruction_substring(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 3) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value end = *stack_get(primary, primary->size - 1);
+    Value start = *stack_get(primary, primary->size - 2);
+    Value* s = stack_get(primary, primary->size - 3);
+    if(start.type != Int) { report_error("the first item is not an integer", primary, secondary, expression, i_ptr); }
+    if(end.type != Int) { report_error("the second item is not an integer", primary, secondary, expression, i_ptr); }
+    if(s->type != String) { report_error("the third item is not a string", primary, secondary, expression, i_ptr); }
+    size_t s_length = strlen(s->value.s);
+    if(start.value.i < 0 || (size_t) start.value.i >= s_length) { report_error("the start index is out of bounds", primary, secondary, expression, i_ptr); }
+    if(end.value.i < 0 || (size_t) end.value.i >= s_length) { report_error("the end index is out of bounds", primary, secondary, expression, i_ptr); }
+    if(end.value.i < start.value.i) { report_error("the end index is smaller than the start index", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    stack_pop(primary);
+    size_t sub_length = end.value.i - start.value.i;
+    char* sub = malloc(sub_length + 1);
+    memcpy(sub, s->value.s + start.value.i, sub_length);
+    sub[sub_length] = '\0';
+    stack_push(primary, value_string(sub));
+    free(sub);
+}
+// get string *l*ength
+void instruction_string_length(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* s = stack_get(primary, primary->size - 1);
+    if(s->type != String) { report_error("the first item is not a string", primary, secondary, expression, i_ptr); }
+    stack_push(primary, value_int(strlen(s->value.s)));
+}
+// put a *r*andom number that is greater or equal to 0 and less than 1 onto the stack
+void instruction_random_float(Stack* primary, Random* rng) {
+    stack_push(primary, value_float(random_float(rng)));
+}
+// *S*eed the random number generator
+void instruction_random_seed(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value seed = *stack_get(primary, primary->size - 1);
+    if(seed.type != Int) { report_error("the first item is not an integer", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    random_seed(rng, (uint64_t) seed.value.i);
+}
+// creates an array of the given (non-negative) length filled with random integers less than 'bound', or with random floats if 'bound' is 0
+static Stack* random_array(Stack* primary, Stack* secondary, Random* rng, long int length, long int bound, char* expression, char* i_ptr) {
+    Stack* a = malloc(sizeof(Stack));
+    a->malloc_size = (size_t) length > 16? (size_t) length : 16;
+    a->values = (size_t) length <= SIZE_MAX / sizeof(Value)? malloc(a->malloc_size * sizeof(Value)) : NULL;
+    if(a->values == NULL) {
+        free(a);
+        report_error("the array length is too large", primary, secondary, expression, i_ptr);
+    }
+    for(size_t v = 0; v < (size_t) length; v += 1) {
+        if(bound == 0) { a->values[v] = value_float(random_float(rng)); }
+        else { a->values[v] = value_int((long int) random_below(rng, (uint64_t) bound)); }
+    }
+    a->size = length;
+    return a;
+}
+// put an *A*rray of random numbers that are greater or equal to 0 and less than 1 onto the stack
+void instruction_random_floats(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value n = *stack_get(primary, primary->size - 1);
+    if(n.type != Int) { report_error("the first item is not an integer", primary, secondary, expression, i_ptr); }
+    if(n.value.i < 0) { report_error("the array length is negative", primary, secondary, expression, i_ptr); }
+    Stack* a = random_array(primary, secondary, rng, n.value.i, 0, expression, i_ptr);
+    stack_pop(primary);
+    stack_push(primary, value_array(a));
+}
+// put an array of random *I*ntegers that are greater or equal to 0 and less than the first item onto the stack
+void instruction_random_ints(Stack* primary, Stack* secondary, Random* rng, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value bound = *stack_get(primary, primary->size - 1);
+    Value n = *stack_get(primary, primary->size - 2);
+    if(bound.type != Int) { report_error("the first item is not an integer", primary, secondary, expression, i_ptr); }
+    if(n.type != Int) { report_error("the second item is not an integer", primary, secondary, expression, i_ptr); }
+    if(bound.value.i <= 0) { report_error("the upper bound is not positive", primary, secondary, expression, i_ptr); }
+    if(n.value.i < 0) { report_error("the array length is negative", primary, secondary, expression, i_ptr); }
+    Stack* a = random_array(primary, secondary, rng, n.value.i, bound.value.i, expression, i_ptr);
+    stack_pop(primary);
+    stack_pop(primary);
+    stack_push(primary, value_array(a));
+}
+// convert integer to *f*loat
+void instruction_to_float(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Int) { report_error("the first item is not an integer", primary, secondary, expression, i_ptr); }
+    x->value.f = (float) x->value.i;
+    x->type = Float;
+}
+// round number at the top of the stack *u*p
+void instruction_round_up(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    x->value.i = (int) ceil(x->value.f);
+    x->type = Int;
+}
+// round number at the top of the stack *d*own
+void instruction_round_down(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    x->value.i = (int) floor(x->value.f);
+    x->type = Int;
+}
+// round number at the top of the stack to the *n*earest integer
+void instruction_round_nearest(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    x->value.i = (int) round(x->value.f);
+    x->type = Int;
+}
+// calulate the *s*ine of the number at the top of the stack
+void instruction_sine(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    x->value.f = sin(x->value.f);
+}
+// calculate the *c*osine of the number at the top of the stack
+void instruction_cosine(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    x->value.f = cos(x->value.f);
+}
+// calculate the *t*angent of the number at the top of the stack
+void instruction_tangent(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    x->value.f = tan(x->value.f);
+}
+// calculate the *a*bsolute value of the number at the top of the stack
+void instruction_absolute(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    switch(x->type) {
+        case Int: x->value.i = labs(x->value.i); break;
+        case Float: x->value.f = fabs(x->value.f); break;
+        default: report_error("the first item is not an integer or float", primary, secondary, expression, i_ptr);
+    }
+}
+// calculate the square *r*oot of the number at the top of the stack
+void instruction_square_root(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 1) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value* x = stack_get(primary, primary->size - 1);
+    if(x->type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    x->value.f = sqrt(x->value.f);
+}
+// calculate the second number on the stack (top - 1) to the power of the first (top), replace with result
+void instruction_power(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    if(primary->size < 2) { report_error("the primary stack does not contain enough items", primary, secondary, expression, i_ptr); }
+    Value n = *stack_get(primary, primary->size - 1);
+    Value* x = stack_get(primary, primary->size - 2);
+    if(n.type != Float) { report_error("the first item is not a float", primary, secondary, expression, i_ptr); }
+    if(x->type != Float) { report_error("the second item is not a float", primary, secondary, expression, i_ptr); }
+    stack_pop(primary);
+    x->value.f = pow(x->value.f, n.value.f);
+}
+// invalid instruction
+void instruction_invalid(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    char error_reason[snprintf(NULL, 0, INVALID_INSTRUCTION_FMT(*i_ptr)) + 1];
+    sprintf(error_reason, INVALID_INSTRUCTION_FMT(*i_ptr));
+    report_error(error_reason, primary, secondary, expression, i_ptr);
+}
+void instruction_unclosed_string(Stack* primary, Stack* secondary, char* expression, char* i_ptr) {
+    report_error("unclosed string literal", primary, secondary, expression, i_ptr);
+}
 
-                    default: b = 0;
-                }
-                if(b) { break; }
-            }
-            // fall through
+// executes the instruction at the given index and returns the index of the instruction to continue at
+size_t program_step(Program* p, size_t i, Stack* primary, Stack* secondary, Random* rng) {
+    Instruction* instruction = &p->instructions[i];
+    char* expression = p->strings + instruction->expression;
+    char* i_ptr = p->strings + instruction->position;
+    switch(instruction->type) {
+        case PushInt: stack_push(primary, value_int(instruction->value.i)); break;
+        case PushFloat: stack_push(primary, value_float(instruction->value.f)); break;
+        case PushString: stack_push(primary, value_string(p->strings + instruction->value.s)); break;
+        case Copy: instruction_copy(primary, secondary, expression, i_ptr); break;
+        case Remove: instruction_remove(primary, secondary, expression, i_ptr); break;
+        case Swap: instruction_swap(primary, secondary, expression, i_ptr); break;
+        case ToSecondary: instruction_to_secondary(primary, secondary, expression, i_ptr); break;
+        case ToPrimary: instruction_to_primary(primary, secondary, expression, i_ptr); break;
+        case Input: instruction_input(primary); break;
+        case Print: instruction_print(primary, secondary, expression, i_ptr); break;
+        case Add: instruction_add(primary, secondary, expression, i_ptr); break;
+        case Subtract: instruction_subtract(primary, secondary, expression, i_ptr); break;
+        case Multiply: instruction_multiply(primary, secondary, expression, i_ptr); break;
+        case Divide: instruction_divide(primary, secondary, expression, i_ptr); break;
+        case Modulo: instruction_modulo(primary, secondary, expression, i_ptr); break;
+        case Less: instruction_less(primary, secondary, expression, i_ptr); break;
+        case Greater: instruction_greater(primary, secondary, expression, i_ptr); break;
+        case Equal: instruction_equal(primary, secondary, expression, i_ptr); break;
+        case And: instruction_and(primary, secondary, expression, i_ptr); break;
+        case Or: instruction_or(primary, secondary, expression, i_ptr); break;
+        case Branch: instruction_branch(primary, secondary, rng, expression, i_ptr); break;
+        case Loop: instruction_loop(primary, secondary, rng, expression, i_ptr); break;
+        case JumpUnless: {
+            if(!instruction_condition(primary, secondary, expression, i_ptr)) { return instruction->value.target; }
+        } break;
+        case Jump: return instruction->value.target;
+        case ArrayCreate: instruction_array_create(primary); break;
+        case ArrayPush: instruction_array_push(primary, secondary, expression, i_ptr); break;
+        case ArrayGet: instruction_array_get(primary, secondary, expression, i_ptr); break;
+        case ArraySet: instruction_array_set(primary, secondary, expression, i_ptr); break;
+        case ArrayRemove: instruction_array_remove(primary, secondary, expression, i_ptr); break;
+        case ArrayLength: instruction_array_length(primary, secondary, expression, i_ptr); break;
+        case Reset: instruction_reset(primary, secondary); break;
+        case PrintRaw: instruction_print_raw(primary, secondary, expression, i_ptr); break;
+        case Debug: instruction_debug(primary, secondary); break;
+        case PrimarySize: instruction_primary_size(primary); break;
+        case SecondarySize: instruction_secondary_size(primary, secondary); break;
+        case SnapshotWrite: instruction_snapshot_write(primary, secondary, expression, i_ptr); break;
+        case SnapshotRead: instruction_snapshot_read(primary, secondary, expression, i_ptr); break;
+        case StringMerge: instruction_string_merge(primary, secondary, expression, i_ptr); break;
+        case Substring: instruction_substring(primary, secondary, expression, i_ptr); break;
+        case StringLength: instruction_string_length(primary, secondary, expression, i_ptr); break;
+        case RandomFloat: instruction_random_float(primary, rng); break;
+        case RandomSeed: instruction_random_seed(primary, secondary, rng, expression, i_ptr); break;
+        case RandomFloats: instruction_random_floats(primary, secondary, rng, expression, i_ptr); break;
+        case RandomInts: instruction_random_ints(primary, secondary, rng, expression, i_ptr); break;
+        case ToFloat: instruction_to_float(primary, secondary, expression, i_ptr); break;
+        case RoundUp: instruction_round_up(primary, secondary, expression, i_ptr); break;
+        case RoundDown: instruction_round_down(primary, secondary, expression, i_ptr); break;
+        case RoundNearest: instruction_round_nearest(primary, secondary, expression, i_ptr); break;
+        case Sine: instruction_sine(primary, secondary, expression, i_ptr); break;
+        case Cosine: instruction_cosine(primary, secondary, expression, i_ptr); break;
+        case Tangent: instruction_tangent(primary, secondary, expression, i_ptr); break;
+        case Absolute: instruction_absolute(primary, secondary, expression, i_ptr); break;
+        case SquareRoot: instruction_square_root(primary, secondary, expression, i_ptr); break;
+        case Power: instruction_power(primary, secondary, expression, i_ptr); break;
+        case Invalid: instruction_invalid(primary, secondary, expression, i_ptr); break;
+        case UnclosedString: instruction_unclosed_string(primary, secondary, expression, i_ptr); break;
+    }
+    return i + 1;
+}
 
-            // invalid instruction
-            default: {
-                char error_reason[snprintf(NULL, 0, INVALID_INSTRUCTION_FMT(*i_ptr))]; 
-                sprintf(error_reason, INVALID_INSTRUCTION_FMT(*i_ptr));
-                report_error(error_reason, primary, secondary, expression, i_ptr);
-            }
-        }
-        i_ptr += 1;
+void program_execute(Program* p, Stack* primary, Stack* secondary, Random* rng) {
+    size_t i = 0;
+    while(i < p->size) {
+        i = program_step(p, i, primary, secondary, rng);
     }
-}
\ No newline at end of file
+}
+
+void interpret(Stack* primary, Stack* secondary, Random* rng, char* expression) {
+    Program p = compile(expression);
+    program_execute(&p, primary, secondary, rng);
+    program_free(&p);
+}
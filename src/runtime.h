@@ -3,6 +3,8 @@
 
 #include <stdlib.h>
 
+#include "random.h"
+
 
 typedef struct Stack {
     struct Value* values;
@@ -11,10 +13,6 @@ typedef struct Stack {
 } Stack;
 
 Stack stack_new();
-void stack_push(Stack* s, struct Value v);
-void stack_set(Stack* s, size_t i, struct Value v);
-struct Value* stack_get(Stack* s, size_t i);
-void stack_pop(Stack* s);
 void stack_free(Stack* s);
 
 
@@ -33,13 +31,79 @@ typedef struct Value {
     } value; 
 } Value;
 
-Value value_int(long int v);
-Value value_float(double v);
+static inline Value value_int(long int v) { return (Value) { .type = Int, .value = { .i = v } }; }
+static inline Value value_float(double v) { return (Value) { .type = Float, .value = { .f = v } }; }
 Value value_string(char* v);
-Value value_array(Stack* v);
+static inline Value value_array(Stack* v) { return (Value) { .type = Array, .value = { .a = v } }; }
 Value value_copy(Value* v);
 void value_print(Value* v);
 void value_free(Value* v);
+int value_truthy(Value* v);
+
+// these are used by every instruction, which is why they are defined here (so that they can be inlined)
+static inline void stack_set(Stack* s, size_t i, Value v) { s->values[i] = v; }
+static inline Value* stack_get(Stack* s, size_t i) { return &s->values[i]; }
+static inline void stack_pop(Stack* s) { s->size -= 1; }
+static inline void stack_push(Stack* s, Value v) {
+    s->size += 1;
+    if(s->size > s->malloc_size) {
+        s->malloc_size *= 2;
+        s->values = realloc(s->values, s->malloc_size * sizeof(Value));
+    }
+    stack_set(s, s->size - 1, v);
+}
+
+
+// every instruction type (in the order of their values), used to define them and to name them
+#define INSTRUCTION_TYPES(X)\
+    X(PushInt) X(PushFloat) X(PushString)\
+    X(Copy) X(Remove) X(Swap) X(ToSecondary) X(ToPrimary)\
+    X(Input) X(Print)\
+    X(Add) X(Subtract) X(Multiply) X(Divide) X(Modulo)\
+    X(Less) X(Greater) X(Equal)\
+    X(And) X(Or)\
+    X(Branch) X(Loop) X(JumpUnless) X(Jump)\
+    X(ArrayCreate) X(ArrayPush) X(ArrayGet) X(ArraySet) X(ArrayRemove) X(ArrayLength)\
+    X(Reset) X(PrintRaw) X(Debug) X(PrimarySize) X(SecondarySize) X(SnapshotWrite) X(SnapshotRead)\
+    X(StringMerge) X(Substring) X(StringLength)\
+    X(RandomFloat) X(RandomSeed) X(RandomFloats) X(RandomInts)\
+    X(ToFloat) X(RoundUp) X(RoundDown) X(RoundNearest) X(Sine) X(Cosine) X(Tangent) X(Absolute) X(SquareRoot) X(Power)\
+    X(Invalid) X(UnclosedString)
+
+#define INSTRUCTION_TYPE_VALUE(name) name,
+
+typedef struct Instruction {
+    enum {
+        INSTRUCTION_TYPES(INSTRUCTION_TYPE_VALUE)
+    } type;
+    union {
+        long int i;
+        double f;
+        size_t s;      // offset of the string inside of the program strings
+        size_t target; // index of the instruction to continue at
+    } value;
+    size_t expression; // offset of the expression the instruction is a part of inside of the program strings
+    size_t position;   // offset of the instruction inside of the program strings
+} Instruction;
+
+extern char* instruction_names[];
+extern size_t instruction_count;
+
+typedef struct Program {
+    Instruction* instructions;
+    size_t size;
+    size_t malloc_size;
+    char* strings;
+    size_t strings_size;
+    size_t strings_malloc_size;
+} Program;
+
+Program program_new();
+void program_push(Program* p, Instruction i);
+size_t program_add_string(Program* p, char* s, size_t length);
+size_t program_step(Program* p, size_t i, Stack* primary, Stack* secondary, Random* rng);
+void program_execute(Program* p, Stack* primary, Stack* secondary, Random* rng);
+void program_free(Program* p);
 
 
-void interpret(Stack* primary, Stack* secondary, char* expression);
\ No newline at end of file
+void interpret(Stack* primary, Stack* secondary, Random* rng, char* expression);
\ No newline at end of file
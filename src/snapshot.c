@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "snapshot.h"
+#include "file.h"
+#include "intern.h"
+
+
+// snapshot file layout:
+//   header
+//   strings (every distinct string once, null-terminated, padded to a multiple of 8 bytes)
+//   values of the primary stack, then of the secondary stack (an array is followed by its elements)
+
+#define SNAPSHOT_MAGIC "SRSS"
+#define SNAPSHOT_VERSION 1
+
+typedef struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t strings_size;
+    uint64_t values_size;
+    uint64_t primary_size;
+    uint64_t secondary_size;
+} SnapshotHeader;
+
+typedef struct SnapshotValue {
+    uint32_t type;
+    uint32_t padding;
+    union {
+        int64_t i;
+        double f;
+        uint64_t s; // offset of the string inside of the snapshot strings
+        uint64_t a; // number of elements following the array
+    } value;
+} SnapshotValue;
+
+
+typedef struct Buffer {
+    char* data;
+    size_t size;
+    size_t malloc_size;
+} Buffer;
+
+static void buffer_append(Buffer* b, void* data, size_t size) {
+    if(b->size + size > b->malloc_size) {
+        if(b->malloc_size == 0) { b->malloc_size = 256; }
+        while(b->size + size > b->malloc_size) { b->malloc_size *= 2; }
+        b->data = realloc(b->data, b->malloc_size);
+    }
+    memcpy(b->data + b->size, data, size);
+    b->size += size;
+}
+
+static uint64_t write_string(Buffer* strings, InternTable* t, char* s) {
+    size_t length = strlen(s);
+    size_t offset = intern_find(t, strings->data, strings->size, s, length);
+    if(offset != INTERN_MISSING) { return offset; }
+    offset = strings->size;
+    buffer_append(strings, s, length + 1);
+    intern_add(t, strings->data, offset);
+    return offset;
+}
+
+static void write_value(Buffer* values, Buffer* strings, InternTable* t, Value* v) {
+    SnapshotValue r = { .type = v->type };
+    switch(v->type) {
+        case Int: r.value.i = v->value.i; break;
+        case Float: r.value.f = v->value.f; break;
+        case String: r.value.s = write_string(strings, t, v->value.s); break;
+        case Array: r.value.a = v->value.a->size; break;
+    }
+    buffer_append(values, &r, sizeof(SnapshotValue));
+    if(v->type == Array) {
+        for(size_t e = 0; e < v->value.a->size; e += 1) {
+            write_value(values, strings, t, stack_get(v->value.a, e));
+        }
+    }
+}
+
+// writes both stacks to the file at the given path, returns 0 on success
+int snapshot_write(char* path, Stack* primary, Stack* secondary) {
+    Buffer strings = { 0 };
+    Buffer values = { 0 };
+    InternTable table = { 0 };
+    for(size_t v = 0; v < primary->size; v += 1) { write_value(&values, &strings, &table, stack_get(primary, v)); }
+    for(size_t v = 0; v < secondary->size; v += 1) { write_value(&values, &strings, &table, stack_get(secondary, v)); }
+    while(strings.size % 8 != 0) { buffer_append(&strings, "", 1); }
+    SnapshotHeader h = {
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .strings_size = strings.size,
+        .values_size = values.size / sizeof(SnapshotValue),
+        .primary_size = primary->size,
+        .secondary_size = secondary->size
+    };
+    // an existing snapshot only gets replaced once the new one has been written completely
+    int failed = 1;
+    char* temporary;
+    FILE* f = file_create(path, &temporary);
+    if(f != NULL) {
+        failed = fwrite(&h, 1, sizeof(SnapshotHeader), f) != sizeof(SnapshotHeader)
+            || fwrite(strings.data, 1, strings.size, f) != strings.size
+            || fwrite(values.data, 1, values.size, f) != values.size;
+        failed = file_commit(f, temporary, path, failed);
+    }
+    free(strings.data);
+    free(values.data);
+    intern_free(&table);
+    return failed;
+}
+
+
+typedef struct Reader {
+    SnapshotValue* values;
+    size_t size;
+    size_t next;
+    char* strings;
+    size_t strings_size;
+} Reader;
+
+// returns 0 on success
+static int read_value(Reader* r, Value* out) {
+    if(r->next >= r->size) { return 1; }
+    SnapshotValue* v = &r->values[r->next];
+    r->next += 1;
+    switch(v->type) {
+        case Int: *out = value_int(v->value.i); return 0;
+        case Float: *out = value_float(v->value.f); return 0;
+        case String: {
+            if(v->value.s >= r->strings_size) { return 1; }
+            *out = value_string(r->strings + v->value.s);
+        } return 0;
+        case Array: {
+            if(v->value.a > r->size - r->next) { return 1; }
+            Stack* a = malloc(sizeof(Stack));
+            a->malloc_size = v->value.a > 16? v->value.a : 16;
+            a->size = 0;
+            a->values = malloc(a->malloc_size * sizeof(Value));
+            for(uint64_t e = 0; e < v->value.a; e += 1) {
+                if(read_value(r, &a->values[a->size])) {
+                    stack_free(a);
+                    free(a);
+                    return 1;
+                }
+                a->size += 1;
+            }
+            *out = value_array(a);
+        } return 0;
+    }
+    return 1;
+}
+
+// replaces both stacks with the contents of the snapshot file at the given path, returns 0 on success (and leaves the stacks unchanged otherwise)
+int snapshot_read(char* path, Stack* primary, Stack* secondary) {
+    size_t size = 0;
+    char* data = file_map(path, &size);
+    if(data == NULL) { return 1; }
+    SnapshotHeader* h = (SnapshotHeader*) data;
+    if(size < sizeof(SnapshotHeader)
+        || memcmp(h->magic, SNAPSHOT_MAGIC, 4) != 0
+        || h->version != SNAPSHOT_VERSION
+        || h->strings_size % 8 != 0
+        || h->strings_size > size - sizeof(SnapshotHeader)
+        || h->values_size > (size - sizeof(SnapshotHeader) - h->strings_size) / sizeof(SnapshotValue)
+        || h->primary_size + h->secondary_size > h->values_size
+        || (h->strings_size > 0 && data[sizeof(SnapshotHeader) + h->strings_size - 1] != '\0')) {
+        file_unmap(data, size);
+        return 1;
+    }
+    Reader r = {
+        .values = (SnapshotValue*) (data + sizeof(SnapshotHeader) + h->strings_size),
+        .size = h->values_size,
+        .next = 0,
+        .strings = data + sizeof(SnapshotHeader),
+        .strings_size = h->strings_size
+    };
+    Stack p = stack_new();
+    Stack s = stack_new();
+    int failed = 0;
+    for(uint64_t v = 0; !failed && v < h->primary_size + h->secondary_size; v += 1) {
+        Value value;
+        failed = read_value(&r, &value);
+        if(!failed) { stack_push(v < h->primary_size? &p : &s, value); }
+    }
+    file_unmap(data, size);
+    if(failed) {
+        stack_free(&p);
+        stack_free(&s);
+        return 1;
+    }
+    stack_free(primary);
+    stack_free(secondary);
+    *primary = p;
+    *secondary = s;
+    return 0;
+}
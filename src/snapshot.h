@@ -0,0 +1,7 @@
+#pragma once
+
+#include "runtime.h"
+
+
+int snapshot_write(char* path, Stack* primary, Stack* secondary);
+int snapshot_read(char* path, Stack* primary, Stack* secondary);